@@ -12,47 +12,57 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "obj/obj.h"
-#include "util/line.h"
+#include "render/wireframe.h"
 #include "util/log.h"
 
+#ifdef SWENDY_RENDER_SERVER
+#include "server/render_server.h"
+#endif
+
 constexpr output::ppm::PPMColor WHITE_COLOR{255, 255, 255};
 
 constexpr auto SURFACE_WIDTH = 1000;
 constexpr auto SURFACE_HEIGHT = 1000;
 
-constexpr int raw_to_screen_cords(double pos) {
-    if (pos < 0) {
-        return static_cast<int>(
-            (500.0 - (std::fabs(pos) * (SURFACE_WIDTH / 2.0))));
-    }
-
-    return static_cast<int>(((pos * (SURFACE_WIDTH / 2.0)) + 500.0));
-}
+int main(int argc, char **argv) {
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
 
-int main() {
     try {
-        output::ppm::PPMOutput output_test(SURFACE_WIDTH, SURFACE_HEIGHT);
-        obj_parser::WavefrontObj obj("monkey.obj");
-
-        for (std::size_t i = 0; i < obj.num_faces(); ++i) {
-            const auto &cur_face = obj.get_face(i);
-
-            for (std::size_t j = 0; j < cur_face.vertices.size(); ++j) {
-                const auto &v0 = cur_face.vertices.at(j);
-                const auto &v1 = cur_face.vertices.at((j + 1) % 3);
+        if (!args.empty() && args.front() == "--serve") {
+#ifdef SWENDY_RENDER_SERVER
+            // swendy_standalone --serve <socket path> <mesh.obj>...
+            if (args.size() < 3) {
+                util::log << "Usage: --serve <socket path> <mesh.obj>...\n";
+                return 1;
+            }
 
-                const util::Vec2<int> p0(
-                    raw_to_screen_cords(v0.x), raw_to_screen_cords(v0.y));
-                const util::Vec2<int> p1(
-                    raw_to_screen_cords(v1.x), raw_to_screen_cords(v1.y));
+            server::RenderServer render_server{std::string(args.at(1))};
 
-                util::plot_line(p0, p1, output_test, WHITE_COLOR);
+            for (std::size_t i = 2; i < args.size(); ++i) {
+                render_server.load_mesh(std::string(args.at(i)));
             }
+
+            render_server.run();
+            return 0;
+#else
+            util::log << "Render server isn't supported on this platform\n";
+            return 1;
+#endif
         }
 
+        output::ppm::PPMOutput output_test(SURFACE_WIDTH, SURFACE_HEIGHT);
+        obj_parser::WavefrontObj obj("monkey.obj");
+
+        render::draw_wireframe(obj, {}, output_test, WHITE_COLOR);
+
         output_test.write_file("test.ppm");
     } catch (const std::exception &e) {
         util::log << "Caught exception: " << e.what() << '\n';
+        return 1;
     }
-}
\ No newline at end of file
+}
@@ -16,11 +16,17 @@
 
 #include <fstream>
 #include <limits>
+#include <stdexcept>
 
+#include "../util/log.h"
+#include "../util/scan_num.h"
 #include "../util/split_string.h"
-#include "../util/str_to_num.h"
 
 namespace obj_parser {
+namespace {
+constexpr std::string_view TOKEN_DELIMS = " \t\r";
+}
+
 WavefrontObj::WavefrontObj(const std::string &file_path) {
     parse_file_data(file_path);
 }
@@ -32,6 +38,10 @@ WavefrontObj::WavefrontObj(const std::vector<char> &buffer) {
 void WavefrontObj::parse_file_data(const std::string &file_path) {
     std::ifstream file(file_path, std::ios::binary);
 
+    if (!file) {
+        throw std::runtime_error("Failed to open " + file_path);
+    }
+
     // Size of file
     file.ignore(std::numeric_limits<std::streamsize>::max());
     std::streamsize file_length = file.gcount();
@@ -50,6 +60,9 @@ void WavefrontObj::parse_buf_data(const std::vector<char> &buffer) {
     std::string line;
     bool inside_comment{false};
 
+    conversion_errors = 0;
+    first_conversion_error.clear();
+
     for (const auto &e : buffer) {
         if (e == '#') {
             inside_comment = true;
@@ -69,6 +82,12 @@ void WavefrontObj::parse_buf_data(const std::vector<char> &buffer) {
             }
         }
     }
+
+    if (conversion_errors != 0) {
+        util::log << "Rejected " << conversion_errors
+                  << " invalid numeric field(s), first was '"
+                  << first_conversion_error << "'\n";
+    }
 }
 
 const Face &WavefrontObj::get_face(std::size_t index) const {
@@ -77,39 +96,53 @@ const Face &WavefrontObj::get_face(std::size_t index) const {
 
 std::size_t WavefrontObj::num_faces() const noexcept { return faces.size(); }
 
-void WavefrontObj::parse_obj_line(const std::string &line) {
-    const auto row_code = util::split_string(line, 0, " ");
+std::size_t WavefrontObj::num_conversion_errors() const noexcept {
+    return conversion_errors;
+}
+
+void WavefrontObj::record_conversion_error(std::string_view field) {
+    if (conversion_errors++ == 0) {
+        first_conversion_error = field;
+    }
+}
+
+double WavefrontObj::to_double(std::string_view field) {
+    double value;
+
+    if (util::scan_decimal(field, value)) {
+        return value;
+    }
+
+    record_conversion_error(field);
+    return {};
+}
+
+void WavefrontObj::parse_obj_line(std::string_view line) {
+    const auto row_code = util::split_string_view(line, 0, TOKEN_DELIMS);
 
     if (row_code == "v") {
         // Is a vertex
-        const auto x_str = util::split_string(line, 1, " ");
-        const auto y_str = util::split_string(line, 2, " ");
-        const auto z_str = util::split_string(line, 3, " ");
+        const auto x_str = util::split_string_view(line, 1, TOKEN_DELIMS);
+        const auto y_str = util::split_string_view(line, 2, TOKEN_DELIMS);
+        const auto z_str = util::split_string_view(line, 3, TOKEN_DELIMS);
 
-        vertices.push_back({util::str_to_num<double>(x_str),
-            util::str_to_num<double>(y_str), util::str_to_num<double>(z_str)});
+        vertices.push_back(
+            {to_double(x_str), to_double(y_str), to_double(z_str)});
     } else if (row_code == "f") {
-        auto extract_vertex = [this](const std::string &part) -> std::size_t {
-            std::string vertex_pos_str;
-            vertex_pos_str.reserve(7);
-            for (const auto &e : part) {
-                if (e != '/') {
-                    vertex_pos_str.push_back(e);
-                } else {
-                    break;
-                }
-            }
+        auto extract_vertex = [this](std::string_view part) -> std::size_t {
+            const auto vertex_pos_str = part.substr(0, part.find('/'));
 
-            const auto vert_pos = util::str_to_num<std::size_t>(vertex_pos_str);
+            std::size_t vert_pos{};
 
-            // Vertex indexes are one-based instead of our usual zero-based
-            if ((vert_pos - 1) < vertices.size()) {
-                return vert_pos - 1;
+            // Vertex indexes are one-based instead of our usual zero-based,
+            // out of range ones are reported along with unparsable ones
+            if (!util::scan_integer(vertex_pos_str, vert_pos) ||
+                (vert_pos - 1) >= vertices.size()) {
+                record_conversion_error(vertex_pos_str);
+                return {};
             }
 
-            util::log << "Index " << vert_pos
-                      << " is larger than our vertice storage\n";
-            return {};
+            return vert_pos - 1;
         };
 
         // Face can have three or more elements separated into three groups
@@ -117,9 +150,12 @@ void WavefrontObj::parse_obj_line(const std::string &line) {
         // We're only interested in the first group within the first three
         // elements (for now at least)
 
-        const auto v1 = extract_vertex(util::split_string(line, 1, " "));
-        const auto v2 = extract_vertex(util::split_string(line, 2, " "));
-        const auto v3 = extract_vertex(util::split_string(line, 3, " "));
+        const auto v1 =
+            extract_vertex(util::split_string_view(line, 1, TOKEN_DELIMS));
+        const auto v2 =
+            extract_vertex(util::split_string_view(line, 2, TOKEN_DELIMS));
+        const auto v3 =
+            extract_vertex(util::split_string_view(line, 3, TOKEN_DELIMS));
 
         faces.push_back({{vertices.at(v1), vertices.at(v2), vertices.at(v3)}});
     }
@@ -17,6 +17,7 @@
 
 #include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace obj_parser {
@@ -39,12 +40,19 @@ public:
     void parse_buf_data(const std::vector<char> &buffer);
     const Face &get_face(std::size_t index) const;
     std::size_t num_faces() const noexcept;
+    // Numeric fields (including out of range face indexes) rejected during
+    // the last parse
+    std::size_t num_conversion_errors() const noexcept;
     virtual ~WavefrontObj() = default;
 
 private:
-    void parse_obj_line(const std::string &line);
+    void parse_obj_line(std::string_view line);
+    void record_conversion_error(std::string_view field);
+    double to_double(std::string_view field);
     std::vector<Vertex> vertices;
     std::vector<Face> faces;
+    std::size_t conversion_errors{};
+    std::string first_conversion_error;
 };
 }  // namespace obj_parser
 
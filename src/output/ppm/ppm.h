@@ -17,6 +17,8 @@
 
 #include <cstdint>
 #include <fstream>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -122,31 +124,34 @@ public:
 
     data_type *data() { return image_data.data(); }
 
-    void write_file(const std::string &path) {
-        std::ofstream file(path, std::ios::binary);
+    // Binary (P6) encoding of the whole surface, header included
+    std::vector<char> to_bytes() const {
+        // Header, width & height, maximum color value
+        const auto header = "P6\n" + std::to_string(width()) + ' ' +
+                            std::to_string(height()) + "\n255\n";
 
-        // Header
-        file << "P6\n";
-        // Width & height
-        file << width() << ' ' << height() << '\n';
-        // Maximum color value
-        file << "255" << '\n';
+        std::vector<char> bytes;
+        bytes.reserve(header.size() + (size() * 3));
+        bytes.insert(bytes.end(), header.begin(), header.end());
 
         for (size_type y = 1; y <= height(); ++y) {
             for (size_type x = 1; x <= width(); ++x) {
                 const auto index = coords_to_index(x, y);
-                const auto r =
-                    static_cast<std::uint8_t>(image_data[index] >> 24U);
-                const auto g =
-                    static_cast<std::uint8_t>(image_data[index] >> 16U);
-                const auto b =
-                    static_cast<std::uint8_t>(image_data[index] >> 8U);
-
-                file.write(reinterpret_cast<const char *>(&r), sizeof(r));
-                file.write(reinterpret_cast<const char *>(&g), sizeof(g));
-                file.write(reinterpret_cast<const char *>(&b), sizeof(b));
+
+                bytes.push_back(static_cast<char>(image_data[index] >> 24U));
+                bytes.push_back(static_cast<char>(image_data[index] >> 16U));
+                bytes.push_back(static_cast<char>(image_data[index] >> 8U));
             }
         }
+
+        return bytes;
+    }
+
+    void write_file(const std::string &path) const {
+        std::ofstream file(path, std::ios::binary);
+        const auto bytes = to_bytes();
+
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
     }
 
     ~PPMOutput() = default;
@@ -0,0 +1,66 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "wireframe.h"
+
+#include <algorithm>
+
+#include "../util/line.h"
+
+namespace render {
+void draw_wireframe(const obj_parser::WavefrontObj &obj, const Camera &camera,
+    output::ppm::PPMOutput &surface, const output::ppm::PPMColor &col) {
+    const auto width = static_cast<double>(surface.width());
+    const auto height = static_cast<double>(surface.height());
+    const auto scale = camera.zoom * (std::min(width, height) / 2.0);
+
+    // Surface coordinates are one-based, positions are truncated towards zero
+    // the same way the cast below does. Checked before the cast so that far
+    // off (or NaN) positions never reach it.
+    auto on_surface = [](double pos, double side) {
+        return pos >= 1.0 && pos < side + 1.0;
+    };
+
+    auto to_screen = [&](const obj_parser::Vertex &v,
+                         util::Vec2<int> &out) -> bool {
+        const auto screen_x = ((v.x - camera.x) * scale) + (width / 2.0);
+        const auto screen_y = ((v.y - camera.y) * scale) + (height / 2.0);
+
+        if (!on_surface(screen_x, width) || !on_surface(screen_y, height)) {
+            return false;
+        }
+
+        out = util::Vec2<int>(
+            static_cast<int>(screen_x), static_cast<int>(screen_y));
+        return true;
+    };
+
+    for (std::size_t i = 0; i < obj.num_faces(); ++i) {
+        const auto &cur_face = obj.get_face(i);
+
+        for (std::size_t j = 0; j < cur_face.vertices.size(); ++j) {
+            util::Vec2<int> p0;
+            util::Vec2<int> p1;
+
+            // No clipping yet, edges leaving the surface are dropped
+            if (!to_screen(cur_face.vertices.at(j), p0) ||
+                !to_screen(cur_face.vertices.at((j + 1) % 3), p1)) {
+                continue;
+            }
+
+            util::plot_line(p0, p1, surface, col);
+        }
+    }
+}
+}  // namespace render
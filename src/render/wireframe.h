@@ -12,28 +12,23 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef STR_TO_NUM_H_
-#define STR_TO_NUM_H_
+#ifndef WIREFRAME_H_
+#define WIREFRAME_H_
 
-#include "log.h"
+#include "../obj/obj.h"
+#include "../output/ppm/ppm.h"
 
-#include <charconv>
-#include <string>
+namespace render {
+struct Camera {
+    // Point of the mesh that ends up at the center of the surface
+    double x{};
+    double y{};
+    // 1.0 maps [-1, 1] onto the shorter surface side
+    double zoom{1.0};
+};
 
-namespace util {
-template <typename T>
-inline T str_to_num(const std::string &str) noexcept {
-    T value;
-    const auto [ptr, ec] =
-        std::from_chars(str.data(), str.data() + str.size(), value);
+void draw_wireframe(const obj_parser::WavefrontObj &obj, const Camera &camera,
+    output::ppm::PPMOutput &surface, const output::ppm::PPMColor &col);
+}  // namespace render
 
-    if (ec == std::errc()) {
-        return value;
-    }
-
-    log << "Failed to convert " << str << " value" << '\n';
-    return {};
-}
-}  // namespace util
-
-#endif  // STR_TO_NUM_H_
\ No newline at end of file
+#endif  // WIREFRAME_H_
@@ -0,0 +1,341 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "render_server.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "../output/ppm/ppm.h"
+#include "../render/wireframe.h"
+#include "../util/log.h"
+#include "../util/scan_num.h"
+#include "../util/split_string.h"
+
+namespace server {
+namespace {
+constexpr output::ppm::PPMColor WHITE_COLOR{255, 255, 255};
+constexpr std::string_view TOKEN_DELIMS = " \t\r";
+
+// Bounds a single request may ask for
+constexpr std::size_t MAX_SURFACE_SIDE = 8192;
+constexpr std::size_t MAX_SURFACE_PIXELS = 4096 * 4096;
+constexpr std::size_t MAX_REQUEST_LENGTH = 4096;
+constexpr auto LISTEN_BACKLOG = 16;
+constexpr std::string_view BUSY_REPLY = "error busy\n";
+// Connections idle (or not reading replies) for this long are dropped
+constexpr timeval CLIENT_TIMEOUT{30, 0};
+
+// Holds a slot of a semaphore for as long as it lives
+class SlotGuard {
+public:
+    explicit SlotGuard(RenderServer::slot_semaphore &sem) noexcept
+        : slots(sem) {}
+    SlotGuard(const SlotGuard &other) = delete;
+    SlotGuard(SlotGuard &&other) = delete;
+    SlotGuard &operator=(const SlotGuard &other) = delete;
+    SlotGuard &operator=(SlotGuard &&other) = delete;
+    ~SlotGuard() { slots.release(); }
+
+private:
+    RenderServer::slot_semaphore &slots;
+};
+
+[[noreturn]] void throw_errno(const std::string &what) {
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Only ever removes a socket, and only one nobody is listening on anymore
+void remove_stale_socket(const std::string &path, const sockaddr_un &addr) {
+    struct stat info {};
+
+    if (lstat(path.c_str(), &info) != 0) {
+        if (errno == ENOENT) {
+            return;
+        }
+
+        throw_errno("Failed to stat " + path);
+    }
+
+    if (!S_ISSOCK(info.st_mode)) {
+        throw std::runtime_error(path + " exists and is not a socket");
+    }
+
+    const int probe_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (probe_fd < 0) {
+        throw_errno("Failed to create socket");
+    }
+
+    const bool in_use = connect(probe_fd,
+                            reinterpret_cast<const sockaddr *>(&addr),
+                            sizeof(addr)) == 0;
+    close(probe_fd);
+
+    if (in_use) {
+        throw std::runtime_error("A server is already running on " + path);
+    }
+
+    if (unlink(path.c_str()) != 0) {
+        throw_errno("Failed to remove stale socket " + path);
+    }
+}
+
+bool send_all(int fd, const char *data, std::size_t length) noexcept {
+    while (length > 0) {
+        // Don't raise SIGPIPE if the client went away mid frame
+        const auto sent = send(fd, data, length, MSG_NOSIGNAL);
+
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        data += sent;
+        length -= static_cast<std::size_t>(sent);
+    }
+
+    return true;
+}
+
+std::string_view optional_token(std::string_view line, int index) {
+    try {
+        return util::split_string_view(line, index, TOKEN_DELIMS);
+    } catch (const std::runtime_error &) {
+        return {};
+    }
+}
+
+std::size_t parse_side(std::string_view token) {
+    std::size_t side{};
+
+    if (!util::scan_integer(token, side) || side == 0 ||
+        side > MAX_SURFACE_SIDE) {
+        throw std::runtime_error("invalid resolution");
+    }
+
+    return side;
+}
+
+double parse_camera_field(std::string_view token, double fallback) {
+    if (token.empty()) {
+        return fallback;
+    }
+
+    double value{};
+    if (!util::scan_decimal(token, value) || !std::isfinite(value)) {
+        throw std::runtime_error("invalid camera");
+    }
+
+    return value;
+}
+}  // namespace
+
+RenderServer::RenderServer(const std::string &socket_path)
+    : path(socket_path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + path);
+    }
+
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    remove_stale_socket(path, addr);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (listen_fd < 0) {
+        throw_errno("Failed to create socket");
+    }
+
+    if (bind(listen_fd, reinterpret_cast<const sockaddr *>(&addr),
+            sizeof(addr)) != 0 ||
+        listen(listen_fd, LISTEN_BACKLOG) != 0) {
+        const auto saved_errno = errno;
+        close(listen_fd);
+        errno = saved_errno;
+        throw_errno("Failed to listen on " + path);
+    }
+}
+
+void RenderServer::load_mesh(const std::string &mesh_path) {
+    auto mesh = std::make_shared<const obj_parser::WavefrontObj>(mesh_path);
+
+    if (mesh->num_conversion_errors() != 0 || mesh->num_faces() == 0) {
+        throw std::runtime_error(mesh_path + " isn't a valid mesh");
+    }
+
+    util::log << "Loaded " << mesh_path << " (" << mesh->num_faces()
+              << " faces)\n";
+
+    const std::lock_guard<std::mutex> lock(meshes_mutex);
+    meshes.insert_or_assign(mesh_path, std::move(mesh));
+}
+
+RenderServer::mesh_ptr RenderServer::find_mesh(std::string_view id) const {
+    const std::lock_guard<std::mutex> lock(meshes_mutex);
+    const auto it = meshes.find(std::string(id));
+
+    if (it == meshes.end()) {
+        return {};
+    }
+
+    return it->second;
+}
+
+void RenderServer::run() {
+    util::log << "Serving renders on " << path << '\n';
+
+    while (!stopping) {
+        const int client_fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+
+        if (client_fd < 0) {
+            if (stopping) {
+                break;
+            }
+
+            if (errno != EINTR) {
+                util::log << "accept failed: " << std::strerror(errno) << '\n';
+            }
+
+            continue;
+        }
+
+        if (!connection_slots.try_acquire()) {
+            send_all(client_fd, BUSY_REPLY.data(), BUSY_REPLY.size());
+            close(client_fd);
+            continue;
+        }
+
+        setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &CLIENT_TIMEOUT,
+            sizeof(CLIENT_TIMEOUT));
+        setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &CLIENT_TIMEOUT,
+            sizeof(CLIENT_TIMEOUT));
+
+        std::thread([this, client_fd] {
+            const SlotGuard slot(connection_slots);
+            handle_client(client_fd);
+            close(client_fd);
+        }).detach();
+    }
+}
+
+void RenderServer::stop() noexcept {
+    stopping = true;
+    // Wakes up the blocking accept in run()
+    shutdown(listen_fd, SHUT_RDWR);
+}
+
+void RenderServer::handle_client(int client_fd) const {
+    std::array<char, MAX_REQUEST_LENGTH> buf{};
+    std::string pending;
+
+    while (true) {
+        const auto received = recv(client_fd, buf.data(), buf.size(), 0);
+
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+
+        // Also covers the idle timeout (EAGAIN)
+        if (received <= 0) {
+            return;
+        }
+
+        pending.append(buf.data(), static_cast<std::size_t>(received));
+
+        std::size_t line_end;
+        while ((line_end = pending.find('\n')) != std::string::npos) {
+            const std::string_view request(pending.data(), line_end);
+            std::vector<char> reply;
+
+            try {
+                reply = handle_request(request);
+            } catch (const std::exception &e) {
+                const auto error = std::string("error ") + e.what() + '\n';
+                reply.assign(error.begin(), error.end());
+            }
+
+            if (!send_all(client_fd, reply.data(), reply.size())) {
+                return;
+            }
+
+            pending.erase(0, line_end + 1);
+        }
+
+        if (pending.size() > MAX_REQUEST_LENGTH) {
+            const std::string_view error = "error request too long\n";
+            send_all(client_fd, error.data(), error.size());
+            return;
+        }
+    }
+}
+
+std::vector<char> RenderServer::handle_request(std::string_view request) const {
+    if (optional_token(request, 0) != "render") {
+        throw std::runtime_error("unknown command");
+    }
+
+    const auto mesh_id = optional_token(request, 1);
+    const auto mesh = find_mesh(mesh_id);
+
+    if (!mesh) {
+        throw std::runtime_error("unknown mesh");
+    }
+
+    const auto width = parse_side(optional_token(request, 2));
+    const auto height = parse_side(optional_token(request, 3));
+
+    if (width * height > MAX_SURFACE_PIXELS) {
+        throw std::runtime_error("invalid resolution");
+    }
+
+    render::Camera camera;
+    camera.x = parse_camera_field(optional_token(request, 4), camera.x);
+    camera.y = parse_camera_field(optional_token(request, 5), camera.y);
+    camera.zoom = parse_camera_field(optional_token(request, 6), camera.zoom);
+
+    // Bounds the memory held by surfaces and their encodings at once
+    job_slots.acquire();
+    const SlotGuard slot(job_slots);
+    output::ppm::PPMOutput surface(width, height);
+    render::draw_wireframe(*mesh, camera, surface, WHITE_COLOR);
+
+    return surface.to_bytes();
+}
+
+RenderServer::~RenderServer() {
+    // Connection threads hold a slot each for as long as they use this
+    for (std::ptrdiff_t i = 0; i < MAX_CONNECTIONS; ++i) {
+        connection_slots.acquire();
+    }
+
+    close(listen_fd);
+    unlink(path.c_str());
+}
+}  // namespace server
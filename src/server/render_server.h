@@ -0,0 +1,79 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RENDER_SERVER_H_
+#define RENDER_SERVER_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../obj/obj.h"
+
+// Long running render daemon listening on a Unix domain socket. Meshes are
+// parsed once at startup and shared by every connection.
+//
+// Each request is a single line:
+//     render <mesh id> <width> <height> [camera x] [camera y] [zoom]
+// and is answered with the frame as binary PPM bytes, or with a single
+// "error <reason>" line. A connection may send any number of requests.
+// Connections beyond the limit below are answered with "error busy", jobs
+// beyond it wait for a free slot. Idle connections are dropped.
+
+namespace server {
+class RenderServer {
+public:
+    using mesh_ptr = std::shared_ptr<const obj_parser::WavefrontObj>;
+    using slot_semaphore = std::counting_semaphore<>;
+
+    static constexpr std::ptrdiff_t MAX_CONNECTIONS = 64;
+    static constexpr std::ptrdiff_t MAX_CONCURRENT_JOBS = 4;
+
+    explicit RenderServer(const std::string &socket_path);
+    RenderServer(const RenderServer &other) = delete;
+    RenderServer(RenderServer &&other) = delete;
+    RenderServer &operator=(const RenderServer &other) = delete;
+    RenderServer &operator=(RenderServer &&other) = delete;
+
+    // Parses the OBJ file at path, it is served under the same name. Throws
+    // if the file can't be read or doesn't hold a valid mesh.
+    void load_mesh(const std::string &path);
+    mesh_ptr find_mesh(std::string_view id) const;
+    // Blocks until stop(), handling each connection on its own thread
+    void run();
+    // Makes run() return, safe to call from any thread
+    void stop() noexcept;
+    // Waits for connections that are still being handled
+    virtual ~RenderServer();
+
+private:
+    void handle_client(int client_fd) const;
+    std::vector<char> handle_request(std::string_view request) const;
+
+    std::string path;
+    int listen_fd{-1};
+    std::atomic<bool> stopping{false};
+    slot_semaphore connection_slots{MAX_CONNECTIONS};
+    mutable slot_semaphore job_slots{MAX_CONCURRENT_JOBS};
+    mutable std::mutex meshes_mutex;
+    std::unordered_map<std::string, mesh_ptr> meshes;
+};
+}  // namespace server
+
+#endif  // RENDER_SERVER_H_
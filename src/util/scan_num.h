@@ -0,0 +1,167 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SCAN_NUM_H_
+#define SCAN_NUM_H_
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace util {
+namespace detail {
+// Powers of ten that are exactly representable as a double
+constexpr std::array<double, 23> EXACT_POW10{1e0, 1e1, 1e2, 1e3, 1e4, 1e5,
+    1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+    1e19, 1e20, 1e21, 1e22};
+
+// Largest digit count whose value always fits in the 53 bit mantissa
+constexpr auto MAX_EXACT_DIGITS = 15;
+
+constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+inline std::uint64_t load_eight_chars(const char *ptr) noexcept {
+    std::uint64_t val;
+    std::memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+inline std::uint32_t load_four_chars(const char *ptr) noexcept {
+    std::uint32_t val;
+    std::memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+// SWAR (eight chars per 64 bit word) digit check and conversion, see
+// https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/
+constexpr bool is_eight_digits(std::uint64_t val) noexcept {
+    return ((val & 0xF0F0F0F0F0F0F0F0U) |
+               (((val + 0x0606060606060606U) & 0xF0F0F0F0F0F0F0F0U) >> 4U)) ==
+           0x3333333333333333U;
+}
+
+constexpr std::uint32_t parse_eight_digits(std::uint64_t val) noexcept {
+    constexpr std::uint64_t mask = 0x000000FF000000FFU;
+    constexpr std::uint64_t mul1 = 100U + (1000000ULL << 32U);
+    constexpr std::uint64_t mul2 = 1U + (10000ULL << 32U);
+
+    val -= 0x3030303030303030U;
+    val = (val * 10U) + (val >> 8U);
+    val = (((val & mask) * mul1) + (((val >> 16U) & mask) * mul2)) >> 32U;
+    return static_cast<std::uint32_t>(val);
+}
+
+// Four digit variant of the above, covers the 6 and 7 digit fractions most
+// exporters write
+constexpr bool is_four_digits(std::uint32_t val) noexcept {
+    return ((val & 0xF0F0F0F0U) |
+               (((val + 0x06060606U) & 0xF0F0F0F0U) >> 4U)) == 0x33333333U;
+}
+
+constexpr std::uint32_t parse_four_digits(std::uint32_t val) noexcept {
+    val -= 0x30303030U;
+    // Bytes 0 and 2 now hold the first and second digit pair
+    val = (val * 10U) + (val >> 8U);
+    return ((val & 0xFFU) * 100U) + ((val >> 16U) & 0xFFU);
+}
+}  // namespace detail
+
+// Scans the plain decimals OBJ exporters write (`-0.192288`, `3`, `.5`)
+// directly into a double. Anything else (exponents, inf/nan, long mantissas)
+// is handed to std::from_chars, so results always match it bit for bit.
+// Returns false if the whole token isn't a number.
+inline bool scan_decimal(std::string_view str, double &value) noexcept {
+    const char *ptr = str.data();
+    const char *const end = ptr + str.size();
+
+    bool negative = false;
+    if (ptr != end && *ptr == '-') {
+        negative = true;
+        ++ptr;
+    }
+
+    // Overflow on long inputs is harmless, they're rejected by digit count
+    std::uint64_t mantissa = 0;
+    const char *const int_start = ptr;
+    while (ptr != end && detail::is_digit(*ptr)) {
+        mantissa = (mantissa * 10U) + static_cast<std::uint64_t>(*ptr - '0');
+        ++ptr;
+    }
+    const auto int_digits = ptr - int_start;
+
+    std::ptrdiff_t frac_digits = 0;
+    if (ptr != end && *ptr == '.') {
+        ++ptr;
+        const char *const frac_start = ptr;
+
+        if constexpr (std::endian::native == std::endian::little) {
+            while ((end - ptr) >= 8) {
+                const auto chunk = detail::load_eight_chars(ptr);
+                if (!detail::is_eight_digits(chunk)) {
+                    break;
+                }
+
+                mantissa = (mantissa * 100000000U) +
+                           detail::parse_eight_digits(chunk);
+                ptr += 8;
+            }
+
+            if ((end - ptr) >= 4) {
+                const auto chunk = detail::load_four_chars(ptr);
+                if (detail::is_four_digits(chunk)) {
+                    mantissa = (mantissa * 10000U) +
+                               detail::parse_four_digits(chunk);
+                    ptr += 4;
+                }
+            }
+        }
+
+        while (ptr != end && detail::is_digit(*ptr)) {
+            mantissa =
+                (mantissa * 10U) + static_cast<std::uint64_t>(*ptr - '0');
+            ++ptr;
+        }
+        frac_digits = ptr - frac_start;
+    }
+
+    const auto total_digits = int_digits + frac_digits;
+
+    if (ptr == end && total_digits > 0 &&
+        total_digits <= detail::MAX_EXACT_DIGITS) {
+        // Exact mantissa divided by an exact power of ten is correctly
+        // rounded, same as from_chars
+        const auto result = static_cast<double>(mantissa) /
+                            detail::EXACT_POW10[static_cast<std::size_t>(
+                                frac_digits)];
+        value = negative ? -result : result;
+        return true;
+    }
+
+    const auto [last, ec] = std::from_chars(str.data(), end, value);
+    return ec == std::errc() && last == end;
+}
+
+// Scans a whole token as an unsigned integer, such as an OBJ face index
+template <typename T>
+inline bool scan_integer(std::string_view str, T &value) noexcept {
+    const char *const end = str.data() + str.size();
+    const auto [last, ec] = std::from_chars(str.data(), end, value);
+    return ec == std::errc() && last == end;
+}
+}  // namespace util
+
+#endif  // SCAN_NUM_H_
@@ -15,54 +15,37 @@
 #ifndef SPLIT_STRING_H_
 #define SPLIT_STRING_H_
 
-#include <array>
-#include <cstring>
-#include <memory>
-#include <string>
+#include <stdexcept>
+#include <string_view>
 
 namespace util {
-inline std::string split_string(
-    const std::string &line, int index, const char *delim) {
-    constexpr auto MAX_STACK_USE_SIZE = 512;
-    const auto str_len = line.length();
-    const char *line_cstr = line.c_str();
+// Returns the index-th token of line, the view points into line
+inline std::string_view split_string_view(
+    std::string_view line, int index, std::string_view delims) {
+    std::size_t token_end = 0;
+    int ctr = 0;
 
-    auto get_token = [line_cstr, str_len, delim, index](char *buf) {
-        int ctr = 0;
-        char *token = nullptr;
-        char *next_token = nullptr;
+    while (true) {
+        const auto token_start = line.find_first_not_of(delims, token_end);
 
-        // Copy data
-        std::strncpy(buf, line_cstr, str_len);
-
-        // Ensure null termination
-        if (buf[str_len] != '\0') {
-            buf[str_len] = '\0';
+        if (token_start == std::string_view::npos) {
+            break;
         }
 
-        token = strtok_r(buf, delim, &next_token);
-
-        while (token != nullptr) {
-            if (ctr == index) {
-                return token;
-            }
+        token_end = line.find_first_of(delims, token_start);
 
-            ctr++;
-            token = strtok_r(nullptr, delim, &next_token);
+        if (token_end == std::string_view::npos) {
+            token_end = line.size();
         }
 
-        throw std::runtime_error("Failed to find matching index");
-    };
+        if (ctr == index) {
+            return line.substr(token_start, token_end - token_start);
+        }
 
-    if (str_len < MAX_STACK_USE_SIZE) {
-        // Use stack
-        std::array<char, MAX_STACK_USE_SIZE> buf{};
-        return std::string(get_token(buf.data()));
-    } else {
-        // Use heap, add one for null terminator
-        auto buf = std::make_unique<char[]>(str_len + 1);
-        return std::string(get_token(buf.get()));
+        ctr++;
     }
+
+    throw std::runtime_error("Failed to find matching index");
 }
 }  // namespace util
 
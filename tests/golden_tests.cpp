@@ -0,0 +1,173 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../src/obj/obj.h"
+#include "../src/output/ppm/ppm.h"
+#include "../src/render/wireframe.h"
+#include "test.h"
+
+// Renders are compared byte for byte against the PPM files in golden/.
+// Run with SWENDY_UPDATE_GOLDEN=1 to regenerate them after an intended
+// change to the output.
+
+namespace {
+constexpr output::ppm::PPMColor WHITE_COLOR{255, 255, 255};
+
+std::vector<char> to_buffer(const std::string &str) {
+    return {str.begin(), str.end()};
+}
+
+std::string coord(double value) { return std::to_string(value); }
+
+// Single triangle, written with the less common number forms and
+// separators exporters sometimes emit
+std::vector<char> triangle_mesh() {
+    return to_buffer(
+        "# synthetic triangle\r\n"
+        "v -8e-1\t-0.8 0\r\n"
+        "v 0.80 -.8 0\r\n"
+        "v 0.0 7.5E-1 0\r\n"
+        "f 1/1/1 2/2/2 3/3/3\r\n");
+}
+
+// Triangle fan around the origin, covers every Bresenham octant
+std::vector<char> fan_mesh() {
+    constexpr auto SEGMENTS = 24;
+    constexpr auto RADIUS = 0.9;
+    constexpr auto TAU = 6.283185307179586;
+
+    std::string obj = "v 0 0 0\n";
+    for (int i = 0; i < SEGMENTS; ++i) {
+        const auto angle = TAU * i / SEGMENTS;
+        obj += "v " + coord(RADIUS * std::cos(angle)) + ' ' +
+               coord(RADIUS * std::sin(angle)) + " 0\n";
+    }
+
+    for (int i = 0; i < SEGMENTS; ++i) {
+        obj += "f 1 " + std::to_string(i + 2) + ' ' +
+               std::to_string(((i + 1) % SEGMENTS) + 2) + '\n';
+    }
+
+    return to_buffer(obj);
+}
+
+// Square grid split into triangles
+std::vector<char> grid_mesh() {
+    constexpr auto CELLS = 8;
+    constexpr auto EXTENT = 0.95;
+
+    std::string obj;
+    for (int y = 0; y <= CELLS; ++y) {
+        for (int x = 0; x <= CELLS; ++x) {
+            obj += "v " + coord(-EXTENT + (2 * EXTENT * x / CELLS)) + ' ' +
+                   coord(-EXTENT + (2 * EXTENT * y / CELLS)) + " 0\n";
+        }
+    }
+
+    for (int y = 0; y < CELLS; ++y) {
+        for (int x = 0; x < CELLS; ++x) {
+            const auto v0 = (y * (CELLS + 1)) + x + 1;
+            const auto v1 = v0 + 1;
+            const auto v2 = v0 + CELLS + 1;
+            const auto v3 = v2 + 1;
+            obj += "f " + std::to_string(v0) + ' ' + std::to_string(v1) + ' ' +
+                   std::to_string(v3) + '\n';
+            obj += "f " + std::to_string(v0) + ' ' + std::to_string(v3) + ' ' +
+                   std::to_string(v2) + '\n';
+        }
+    }
+
+    return to_buffer(obj);
+}
+
+std::vector<char> read_file(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>()};
+}
+
+void check_golden(const std::string &name,
+    const obj_parser::WavefrontObj &obj, std::size_t width,
+    std::size_t height, const render::Camera &camera = {}) {
+    test::check(obj.num_conversion_errors() == 0, "Mesh failed to parse");
+
+    output::ppm::PPMOutput surface(width, height);
+    render::draw_wireframe(obj, camera, surface, WHITE_COLOR);
+
+    const auto file_name = name + '_' + std::to_string(width) + 'x' +
+                           std::to_string(height) + ".ppm";
+    const auto golden_path = std::string(SWENDY_GOLDEN_DIR) + '/' + file_name;
+
+    if (std::getenv("SWENDY_UPDATE_GOLDEN") != nullptr) {
+        surface.write_file(golden_path);
+        return;
+    }
+
+    const auto expected = read_file(golden_path);
+    test::check(!expected.empty(), "Missing golden image " + golden_path);
+
+    // Compares what write_file produces, the render is left behind in the
+    // working directory for diffing if it doesn't match
+    surface.write_file(file_name);
+    test::check(read_file(file_name) == expected,
+        file_name + " differs from its golden image");
+    std::remove(file_name.c_str());
+}
+
+const obj_parser::WavefrontObj &monkey() {
+    static const obj_parser::WavefrontObj obj(
+        std::string(SWENDY_RES_DIR) + "/monkey.obj");
+    return obj;
+}
+
+const test::Register monkey_square("golden", "monkey_square", [] {
+    check_golden("monkey", monkey(), 128, 128);
+    check_golden("monkey", monkey(), 256, 256);
+});
+
+const test::Register monkey_wide("golden", "monkey_wide",
+    [] { check_golden("monkey", monkey(), 320, 180); });
+
+const test::Register monkey_camera("golden", "monkey_camera", [] {
+    // Zoomed in far enough that edges leave the surface
+    render::Camera camera;
+    camera.x = 0.25;
+    camera.y = 0.25;
+    camera.zoom = 2.0;
+    check_golden("monkey_zoomed", monkey(), 256, 256, camera);
+});
+
+const test::Register synthetic("golden", "synthetic", [] {
+    const obj_parser::WavefrontObj triangle(triangle_mesh());
+    const obj_parser::WavefrontObj fan(fan_mesh());
+    const obj_parser::WavefrontObj grid(grid_mesh());
+
+    test::check(triangle.num_faces() == 1, "Triangle face count");
+    test::check(fan.num_faces() == 24, "Fan face count");
+    test::check(grid.num_faces() == 128, "Grid face count");
+
+    check_golden("triangle", triangle, 64, 64);
+    check_golden("fan", fan, 97, 97);
+    check_golden("fan", fan, 200, 120);
+    check_golden("grid", grid, 150, 150);
+});
+}  // namespace
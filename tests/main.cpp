@@ -0,0 +1,47 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <string_view>
+
+#include "test.h"
+
+// swendy_tests [suite]
+int main(int argc, char **argv) {
+    const std::string_view suite = argc > 1 ? argv[1] : "";
+    int ran = 0;
+    int failed = 0;
+
+    for (const auto &test_case : test::registry()) {
+        if (!suite.empty() && test_case.suite != suite) {
+            continue;
+        }
+
+        ++ran;
+
+        try {
+            test_case.body();
+            std::cout << "[ PASS ] " << test_case.suite << '.'
+                      << test_case.name << '\n';
+        } catch (const std::exception &e) {
+            ++failed;
+            std::cout << "[ FAIL ] " << test_case.suite << '.'
+                      << test_case.name << ": " << e.what() << '\n';
+        }
+    }
+
+    std::cout << ran - failed << '/' << ran << " tests passed\n";
+
+    return (ran == 0 || failed != 0) ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/obj/obj.h"
+#include "../src/util/scan_num.h"
+#include "test.h"
+
+// The number scanner must agree with std::from_chars bit for bit, on both
+// its fast path and the forms it hands off.
+
+namespace {
+// Appended rather than concatenated, GCC 12 emits a false -Wrestrict for
+// operator+ chains like this in optimized builds
+std::string quoted(std::string_view str, std::string_view what) {
+    std::string msg = "'";
+    msg.append(str).append("' ").append(what);
+    return msg;
+}
+
+void check_matches_from_chars(std::string_view str) {
+    double expected{};
+    const auto [last, ec] =
+        std::from_chars(str.data(), str.data() + str.size(), expected);
+    const bool expected_ok =
+        ec == std::errc() && last == str.data() + str.size();
+
+    double actual{};
+    const bool actual_ok = util::scan_decimal(str, actual);
+
+    test::check(actual_ok == expected_ok,
+        quoted(str, "accepted differently than from_chars"));
+
+    if (expected_ok) {
+        test::check(std::bit_cast<std::uint64_t>(actual) ==
+                        std::bit_cast<std::uint64_t>(expected),
+            quoted(str, "differs from from_chars"));
+    }
+}
+
+obj_parser::WavefrontObj parse_text(const std::string &obj) {
+    return obj_parser::WavefrontObj(std::vector<char>(obj.begin(), obj.end()));
+}
+
+const test::Register decimal_forms("parse", "decimal_forms", [] {
+    for (const auto *str : {"0", "-0", "-0.0", "3", ".5", "-.5", "5.",
+             "-0.192288", "0.1923", "-0.1922881", "123456.789"}) {
+        check_matches_from_chars(str);
+    }
+});
+
+const test::Register decimal_rejects("parse", "decimal_rejects", [] {
+    for (const auto *str : {"", "-", ".", "-.", "+1", "1.2.3", "0.5x",
+             "0.5 ", " 0.5", "0x10", "1e", "--1"}) {
+        double value{};
+        test::check(!util::scan_decimal(str, value),
+            quoted(str, "should be rejected"));
+        check_matches_from_chars(str);
+    }
+});
+
+const test::Register decimal_fallback("parse", "decimal_fallback", [] {
+    // Around the 15 significant digit fast path limit
+    check_matches_from_chars("0.12345678901234");
+    check_matches_from_chars("0.123456789012345");
+    check_matches_from_chars("0.1234567890123456");
+    check_matches_from_chars("1234567890.12345");
+    check_matches_from_chars("1234567890.123456");
+    check_matches_from_chars("9007199254740993");
+
+    // Forms only from_chars handles
+    for (const auto *str : {"1e5", "-8e-1", "7.5E-1", "1e308", "1e400",
+             "4.9e-324", "inf", "-inf", "nan", "infinity"}) {
+        check_matches_from_chars(str);
+    }
+});
+
+const test::Register decimal_swar("parse", "decimal_swar", [] {
+    // Fraction lengths around the four and eight digit SWAR steps
+    for (const auto *str :
+        {"0.1", "0.12", "0.123", "0.1234", "0.12345", "0.123456", "0.1234567",
+            "0.12345678", "-1.12345678", "0.123456789", "0.123456789012",
+            "0.1234567812345678", "-0.9999999999999999", "0.00000001",
+            "0.1234a678", "0.12345a78", "0.1234567a"}) {
+        check_matches_from_chars(str);
+    }
+});
+
+const test::Register integers("parse", "integers", [] {
+    std::size_t value{};
+    test::check(util::scan_integer("42", value) && value == 42, "'42'");
+    test::check(!util::scan_integer("", value), "Empty index accepted");
+    test::check(!util::scan_integer("-1", value), "Negative index accepted");
+    test::check(!util::scan_integer("4x", value), "'4x' accepted");
+    test::check(!util::scan_integer("99999999999999999999999", value),
+        "Overflowing index accepted");
+});
+
+const test::Register face_indexes("parse", "face_indexes", [] {
+    const auto valid = parse_text("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1/2/3 2 3\n");
+    test::check(valid.num_conversion_errors() == 0, "Valid mesh rejected");
+    test::check(valid.num_faces() == 1, "Valid face count");
+
+    const auto invalid = parse_text(
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "f 0 2 3\n"     // zero index
+        "f 1 4 3\n"     // out of range
+        "f 1 2 x/1\n"   // non numeric
+        "f 1 -2 3\n");  // relative indexes aren't supported
+    test::check(invalid.num_conversion_errors() == 4,
+        "Expected 4 rejected indexes, got " +
+            std::to_string(invalid.num_conversion_errors()));
+    test::check(invalid.num_faces() == 4, "Invalid face count");
+
+    const auto bad_vertex = parse_text("v 0 abc 0\nv 1 0 0\nv 0 1 0\n");
+    test::check(bad_vertex.num_conversion_errors() == 1,
+        "Expected 1 rejected coordinate");
+});
+}  // namespace
@@ -0,0 +1,131 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "../src/obj/obj.h"
+#include "../src/output/ppm/ppm.h"
+#include "../src/render/wireframe.h"
+#include "test.h"
+
+// Per stage wall time and heap allocation budgets. Allocation counts are
+// deterministic and catch per token / per pixel allocations creeping back
+// in, they're checked in every build. Time budgets only mean something for
+// optimized, uninstrumented builds, elsewhere timings are just reported
+// (see SWENDY_ENFORCE_TIME_BUDGETS in tests/CMakeLists.txt).
+
+namespace {
+std::atomic<std::size_t> allocation_count{0};
+
+void *counted_alloc(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+}  // namespace
+
+void *operator new(std::size_t size) { return counted_alloc(size); }
+void *operator new[](std::size_t size) { return counted_alloc(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+constexpr output::ppm::PPMColor WHITE_COLOR{255, 255, 255};
+constexpr auto RUNS = 5;
+
+struct Budget {
+    double max_millis;
+    std::size_t max_allocations;
+};
+
+// Runs stage RUNS times, checks the fastest run and the allocations of a
+// single run against budget
+template <typename F>
+void check_stage(const std::string &name, const Budget &budget, F &&stage) {
+    using clock = std::chrono::steady_clock;
+    double best_millis{};
+    std::size_t allocations{};
+
+    for (int i = 0; i < RUNS; ++i) {
+        const auto allocs_before = allocation_count.load();
+        const auto start = clock::now();
+        stage();
+        const auto end = clock::now();
+
+        const std::chrono::duration<double, std::milli> elapsed = end - start;
+        if (i == 0 || elapsed.count() < best_millis) {
+            best_millis = elapsed.count();
+        }
+        allocations = allocation_count.load() - allocs_before;
+    }
+
+    std::cout << "  " << name << ": " << best_millis << " ms, " << allocations
+              << " allocations\n";
+
+    const bool enforce_time = SWENDY_ENFORCE_TIME_BUDGETS != 0;
+    test::check(!enforce_time || best_millis <= budget.max_millis,
+        name + " took " + std::to_string(best_millis) + " ms, budget is " +
+            std::to_string(budget.max_millis) + " ms");
+    test::check(allocations <= budget.max_allocations,
+        name + " made " + std::to_string(allocations) +
+            " allocations, budget is " +
+            std::to_string(budget.max_allocations));
+}
+
+const std::string MONKEY_PATH = std::string(SWENDY_RES_DIR) + "/monkey.obj";
+
+// Time budgets are ~2.5x the slowest of eight Release runs on a single core
+// Xeon VM with GCC 12 (parse 3.3 ms, rasterize 0.85 ms, encode 5.0 ms).
+// Re-measure and update them when the hardware or the stage changes.
+
+const test::Register parse("perf", "parse", [] {
+    check_stage("parse monkey.obj", {8.0, 64}, [] {
+        const obj_parser::WavefrontObj obj(MONKEY_PATH);
+        test::check(obj.num_faces() == 1968, "Unexpected face count");
+    });
+});
+
+const test::Register rasterize("perf", "rasterize", [] {
+    const obj_parser::WavefrontObj obj(MONKEY_PATH);
+    // Allocated up front so only the rasterizer is measured, redrawing the
+    // same mesh does the same work every run
+    output::ppm::PPMOutput surface(1000, 1000);
+
+    check_stage("rasterize 1000x1000", {2.0, 0}, [&obj, &surface] {
+        render::draw_wireframe(obj, {}, surface, WHITE_COLOR);
+    });
+});
+
+const test::Register encode("perf", "encode", [] {
+    const obj_parser::WavefrontObj obj(MONKEY_PATH);
+    output::ppm::PPMOutput surface(1000, 1000);
+    render::draw_wireframe(obj, {}, surface, WHITE_COLOR);
+
+    check_stage("encode 1000x1000", {12.0, 4}, [&surface] {
+        const auto bytes = surface.to_bytes();
+        test::check(!bytes.empty(), "Empty encoding");
+    });
+});
+}  // namespace
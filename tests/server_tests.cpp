@@ -0,0 +1,206 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/server/render_server.h"
+#include "test.h"
+
+// Talks to a RenderServer over a real socket in the test's /tmp
+
+namespace {
+const std::string MONKEY_PATH = std::string(SWENDY_RES_DIR) + "/monkey.obj";
+
+std::string socket_path(const std::string &name) {
+    return "/tmp/swendy_tests_" + std::to_string(getpid()) + '_' + name +
+           ".sock";
+}
+
+sockaddr_un socket_addr(const std::string &path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+// Sends data, then reads replies until the server closes the connection
+std::string exchange(const std::string &path, const std::string &data) {
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    test::check(fd >= 0, "Failed to create socket");
+
+    const auto addr = socket_addr(path);
+    test::check(connect(fd, reinterpret_cast<const sockaddr *>(&addr),
+                    sizeof(addr)) == 0,
+        "Failed to connect to " + path);
+
+    test::check(send(fd, data.data(), data.size(), MSG_NOSIGNAL) ==
+                    static_cast<ssize_t>(data.size()),
+        "Failed to send request");
+    shutdown(fd, SHUT_WR);
+
+    std::string reply;
+    std::array<char, 65536> buf{};
+    ssize_t received;
+    while ((received = recv(fd, buf.data(), buf.size(), 0)) > 0) {
+        reply.append(buf.data(), static_cast<std::size_t>(received));
+    }
+
+    close(fd);
+    return reply;
+}
+
+std::string read_file(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+// Runs a server with monkey.obj loaded for as long as it lives
+class TestServer {
+public:
+    explicit TestServer(const std::string &socket)
+        : path(socket), server(socket) {
+        server.load_mesh(MONKEY_PATH);
+        thread = std::thread([this] { server.run(); });
+    }
+
+    TestServer(const TestServer &other) = delete;
+    TestServer(TestServer &&other) = delete;
+    TestServer &operator=(const TestServer &other) = delete;
+    TestServer &operator=(TestServer &&other) = delete;
+
+    ~TestServer() {
+        server.stop();
+        thread.join();
+    }
+
+    std::string path;
+    server::RenderServer server;
+    std::thread thread;
+};
+
+std::string render_request(const std::string &args) {
+    return "render " + MONKEY_PATH + ' ' + args + '\n';
+}
+
+const test::Register render("server", "render", [] {
+    const TestServer running(socket_path("render"));
+
+    const auto reply = exchange(running.path, render_request("256 256"));
+    test::check(
+        reply == read_file(std::string(SWENDY_GOLDEN_DIR) +
+                           "/monkey_256x256.ppm"),
+        "Served frame differs from its golden image");
+});
+
+const test::Register errors("server", "errors", [] {
+    const TestServer running(socket_path("errors"));
+
+    auto check_reply = [&running](
+                           const std::string &request, const std::string &want) {
+        const auto reply = exchange(running.path, request);
+        test::check(reply == want,
+            "'" + request + "' got '" + reply + "', expected '" + want + "'");
+    };
+
+    check_reply("bogus\n", "error unknown command\n");
+    check_reply("render\n", "error unknown mesh\n");
+    check_reply("render nope.obj 8 8\n", "error unknown mesh\n");
+    check_reply(render_request(""), "error invalid resolution\n");
+    check_reply(render_request("0 8"), "error invalid resolution\n");
+    check_reply(render_request("8 x"), "error invalid resolution\n");
+    check_reply(render_request("8193 8"), "error invalid resolution\n");
+    check_reply(render_request("8192 8192"), "error invalid resolution\n");
+    check_reply(render_request("8 8 x"), "error invalid camera\n");
+    check_reply(render_request("8 8 0 0 nan"), "error invalid camera\n");
+    check_reply(render_request("8 8 0 inf"), "error invalid camera\n");
+    check_reply(std::string(5000, 'x'), "error request too long\n");
+});
+
+const test::Register pipelined("server", "pipelined", [] {
+    const TestServer running(socket_path("pipelined"));
+
+    const auto frame = exchange(running.path, render_request("16 8"));
+    test::check(frame.rfind("P6\n16 8\n255\n", 0) == 0, "Bad frame header");
+
+    // Requests may arrive in one send, CRLF terminated or not
+    const auto reply =
+        exchange(running.path, render_request("16 8") + "bogus\r\n" +
+                                   render_request("16 8\r"));
+    test::check(reply == frame + "error unknown command\n" + frame,
+        "Pipelined replies out of order or corrupted");
+});
+
+const test::Register bad_meshes("server", "bad_meshes", [] {
+    server::RenderServer render_server(socket_path("bad_meshes"));
+    const auto bad_obj = socket_path("bad_meshes") + ".obj";
+
+    test::check_throws(
+        [&] { render_server.load_mesh("/nonexistent/mesh.obj"); },
+        "Missing mesh was loaded");
+
+    std::ofstream(bad_obj) << "v 0 x 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    test::check_throws(
+        [&] { render_server.load_mesh(bad_obj); }, "Invalid mesh was loaded");
+
+    std::ofstream(bad_obj) << "v 0 0 0\n";
+    test::check_throws(
+        [&] { render_server.load_mesh(bad_obj); }, "Empty mesh was loaded");
+
+    unlink(bad_obj.c_str());
+});
+
+const test::Register socket_path_guard("server", "socket_path_guard", [] {
+    const auto path = socket_path("guard");
+
+    // Regular files are never removed
+    std::ofstream(path) << "keep";
+    test::check_throws([&] { server::RenderServer render_server(path); },
+        "Server replaced a regular file");
+    test::check(read_file(path) == "keep", "Regular file was modified");
+    unlink(path.c_str());
+
+    // A live server isn't taken over
+    {
+        const TestServer running(path);
+        test::check_throws([&] { server::RenderServer render_server(path); },
+            "Server took over a live socket");
+        test::check(exchange(path, "bogus\n") == "error unknown command\n",
+            "Live server stopped answering");
+    }
+
+    // A socket nobody listens on anymore is reclaimed
+    const int stale_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    const auto addr = socket_addr(path);
+    test::check(bind(stale_fd, reinterpret_cast<const sockaddr *>(&addr),
+                    sizeof(addr)) == 0,
+        "Failed to create stale socket");
+    close(stale_fd);
+
+    const TestServer running(path);
+    test::check(exchange(path, "bogus\n") == "error unknown command\n",
+        "Server didn't reclaim stale socket");
+});
+}  // namespace
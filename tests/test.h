@@ -0,0 +1,73 @@
+// Copyright 2021 Bennett Anderson
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <functional>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Tiny self contained test harness. Each suite registers itself statically
+// and is run by name, so every suite can be its own CTest entry.
+
+namespace test {
+struct TestCase {
+    std::string_view suite;
+    std::string_view name;
+    std::function<void()> body;
+};
+
+inline std::vector<TestCase> &registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+struct Register {
+    Register(std::string_view suite, std::string_view name,
+        std::function<void()> body) {
+        registry().push_back({suite, name, std::move(body)});
+    }
+};
+
+class Failure : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+inline void check(bool condition, const std::string &what,
+    std::source_location loc = std::source_location::current()) {
+    if (!condition) {
+        throw Failure(std::string(loc.file_name()) + ':' +
+                      std::to_string(loc.line()) + ": " + what);
+    }
+}
+
+template <typename F>
+void check_throws(F &&body, const std::string &what,
+    std::source_location loc = std::source_location::current()) {
+    try {
+        body();
+    } catch (const std::exception &) {
+        return;
+    }
+
+    check(false, what, loc);
+}
+}  // namespace test
+
+#endif  // TEST_H_